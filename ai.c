@@ -0,0 +1,194 @@
+/** @file   ai.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A module for a computer player of the throw and catch
+            game, used to play long rallies without anyone at the
+            boards
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ai.h"
+#include "board.h"
+#include "ball.h"
+#include "player.h"
+#include "prng.h"
+
+#define MAX_ROW_POS (FIELD_ROWS_NUM - 1)
+#define MAX_COL_POS (FIELD_COLS_NUM - 1)
+
+
+/**
+ * Initialises the computer player
+ * @param uint8_t skill percentage of balls it judges the landing row right for
+ * @param uint8_t reaction input ticks before it reacts to a ball or throws
+ * @param uint8_t speed_index speed it chooses, 0 to 2
+ * @param bool serve whether it chooses the speed or waits for the other board
+ * @param uint16_t seed to repeat the same misjudgements
+ */
+void ai_init (ai_t *ai, uint8_t skill, uint8_t reaction, uint8_t speed_index,
+              bool serve, uint16_t seed)
+{
+    ai->skill = skill;
+    ai->reaction = reaction;
+    ai->speed_index = speed_index;
+    ai->serve = serve;
+    ai->state = STATE_INIT;
+    ai->wait = reaction;
+    ai->target = 0;
+    ai->judged = false;
+    ai->holding = false;
+    prng_init (&ai->prng, seed);
+}
+
+
+/**
+ * Predicts where the ball will reach the column of the player. The
+ * ball falls straight down its row, so it lands on the row it is on,
+ * after the remaining columns at the speed of the ball.
+ * @param uint8_t row set to the row the ball will land on
+ * @param uint16_t ticks set to the input ticks before it lands
+ * @return true if the ball is on its way to the player
+ */
+bool ai_predict (const board_t *board, uint8_t *row, uint16_t *ticks)
+{
+    const ball_t *ball = &board->ball;
+    uint8_t y_pos = get_ball_y_pos (ball);
+    uint16_t ball_ticks;
+
+    if (board->state != STATE_PLAYING || !board->ball_on_screen
+        || get_ball_direction (ball) != DOWN || y_pos > MAX_COL_POS)
+        return false;
+
+    ball_ticks = (uint16_t) (MAX_COL_POS - y_pos) * ball->speed;
+    *row = get_ball_x_pos (ball);
+    *ticks = ball_ticks * AI_INPUT_RATE / AI_BALL_RATE;
+    return true;
+}
+
+
+/*
+ * Counts down the wait
+ * @return true once there is no wait left
+ */
+static bool ai_ready_p (ai_t *ai)
+{
+    if (ai->wait) {
+        ai->wait--;
+        return false;
+    }
+    return true;
+}
+
+
+/*
+ * To get the navswitch event that moves the paddle a row
+ * towards the target
+ */
+static uint8_t ai_move (const ai_t *ai, uint8_t pos)
+{
+    if (ai->target < pos)
+        return BOARD_INPUT_NORTH;
+    if (ai->target > pos)
+        return BOARD_INPUT_SOUTH;
+    return 0;
+}
+
+
+/*
+ * Plays a round: catches the ball when it is on its way, and when
+ * holding the ball moves to a random row and throws it
+ */
+static uint8_t ai_play (ai_t *ai, const board_t *board)
+{
+    uint8_t pos = get_player_pos (&board->player);
+    uint8_t row;
+    uint16_t ticks;
+
+    if (board->player.has_ball) {
+        if (!ai->holding) {
+            ai->holding = true;
+            ai->target = prng_next (&ai->prng) % FIELD_ROWS_NUM;
+            ai->wait = ai->reaction;
+        }
+        if (pos != ai->target)
+            return ai_move (ai, pos);
+        return ai_ready_p (ai) ? BOARD_INPUT_PUSH : 0;
+    }
+    ai->holding = false;
+
+    if (!ai_predict (board, &row, &ticks)) {
+        ai->judged = false;
+        return 0;
+    }
+
+    if (!ai->judged) {
+        ai->judged = true;
+        ai->wait = ai->reaction;
+        ai->target = row;
+        if (!prng_chance (&ai->prng, ai->skill)) {
+            /* Misjudges the landing row by one */
+            if (row == 0 || (row < MAX_ROW_POS && prng_chance (&ai->prng, 50)))
+                ai->target = row + 1;
+            else
+                ai->target = row - 1;
+        }
+    }
+    if (!ai_ready_p (ai))
+        return 0;
+
+    /* Gives up on a ball it cannot reach, a row is moved each tick */
+    if ((pos > ai->target ? pos - ai->target : ai->target - pos) > ticks + 1)
+        return 0;
+    return ai_move (ai, pos);
+}
+
+
+/**
+ * Makes the navswitch events for the board, to be called at
+ * AI_INPUT_RATE in place of reading the navswitch
+ * @return the BOARD_INPUT bits to pass to board_input
+ */
+uint8_t ai_input (ai_t *ai, const board_t *board)
+{
+    if (board->state != ai->state) {
+        ai->state = board->state;
+        switch (board->state) {
+            case STATE_INIT:
+                ai->wait = ai->reaction;
+                break;
+            case STATE_SETUP:
+                ai->wait = ai->reaction;
+                break;
+            case STATE_PLAYING:
+                ai->judged = false;
+                ai->holding = false;
+                break;
+            case STATE_OVER:
+                ai->wait = AI_OVER_WAIT;
+                break;
+        }
+    }
+
+    switch (board->state) {
+        case STATE_INIT:
+            return ai_ready_p (ai) ? BOARD_INPUT_PUSH : 0;
+        case STATE_SETUP:
+            /* Only the serving player chooses the speed, the other waits
+               for it to arrive so the ball is never served from both boards */
+            if (!ai->serve || !ai_ready_p (ai))
+                return 0;
+            if (board->speed_index < ai->speed_index)
+                return BOARD_INPUT_WEST;
+            if (board->speed_index > ai->speed_index)
+                return BOARD_INPUT_EAST;
+            return BOARD_INPUT_PUSH;
+        case STATE_PLAYING:
+            return ai_play (ai, board);
+        case STATE_OVER:
+            if (board->reset)
+                return 0;
+            return ai_ready_p (ai) ? BOARD_INPUT_PUSH : 0;
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+/** @file   ai.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the computer player of the catch throw game
+
+    The computer player makes the navswitch events for a board, so a
+    board can be played without anyone at it. It predicts where the
+    ball will land and moves the paddle there after a reaction delay,
+    and sometimes misjudges the landing row depending on its skill.
+*/
+
+#ifndef AI_H
+#define AI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+#include "prng.h"
+
+/* Rates that ai_input and the ball of the board are updated at */
+#define AI_INPUT_RATE 100
+#define AI_BALL_RATE 250
+
+/* Input ticks to wait at the end of a round before starting the next */
+#define AI_OVER_WAIT AI_INPUT_RATE
+
+typedef struct ai_struct
+{
+    uint8_t skill; // Percentage of balls the landing row is judged right for
+    uint8_t reaction; // Input ticks before reacting to a ball or throwing
+    uint8_t speed_index; // Speed chosen when serving
+    bool serve; // Whether this player chooses the speed
+    state_t state; // State of the board when last called
+    uint16_t wait; // Input ticks left before acting
+    uint8_t target; // Row the paddle is moving to
+    bool judged; // Whether the landing row of the ball on its way is known
+    bool holding; // Whether the row to throw from has been chosen
+    prng_t prng;
+} ai_t;
+
+void ai_init (ai_t *, uint8_t, uint8_t, uint8_t, bool, uint16_t);
+
+bool ai_predict (const board_t *, uint8_t *, uint16_t *);
+
+uint8_t ai_input (ai_t *, const board_t *);
+
+#endif //AI_H
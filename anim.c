@@ -0,0 +1,115 @@
+/** @file   anim.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A module to play the run length encoded animations
+            of the throw and catch game
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "anim.h"
+#include "tinygl.h"
+
+#define ANIM_RUN_ON 0x80
+#define ANIM_RUN_LENGTH 0x7f
+
+
+/*
+ * Initialises the animation to be stopped
+ * @param uint16_t poll_rate the rate anim_update is called at
+ */
+anim_t anim_init (anim_obj_t *obj, uint16_t poll_rate) {
+    obj->next = 0;
+    obj->ticks = 0;
+    obj->poll_rate = poll_rate;
+    return obj;
+}
+
+
+/*
+ * Starts playing a sequence from its first frame, replacing any
+ * animation already playing. Only remembers where the sequence is,
+ * the first frame is read by the next anim_update
+ */
+void anim_play (anim_t anim, const uint8_t *sequence) {
+    anim->next = sequence;
+    anim->ticks = 0;
+}
+
+
+/* To stop the animation playing */
+void anim_stop (anim_t anim) {
+    anim->next = 0;
+    anim->ticks = 0;
+}
+
+
+/*
+ * Reads the next frame of the sequence into the columns,
+ * stopping the animation at the end of the sequence
+ */
+static void anim_frame_read (anim_t anim) {
+    const uint8_t *next = anim->next;
+    uint8_t time = ANIM_READ (next++);
+    uint8_t pixel = 0;
+    uint32_t ticks;
+    uint8_t i;
+
+    if (time == ANIM_END) {
+        anim_stop (anim);
+        return;
+    }
+
+    for (i = 0; i < ANIM_WIDTH; i++)
+        anim->columns[i] = 0;
+
+    while (pixel < ANIM_PIXELS) {
+        uint8_t run = ANIM_READ (next++);
+        uint8_t length = run & ANIM_RUN_LENGTH;
+
+        for (; length && pixel < ANIM_PIXELS; length--, pixel++) {
+            if (run & ANIM_RUN_ON)
+                anim->columns[pixel / ANIM_HEIGHT] |= 1 << (pixel % ANIM_HEIGHT);
+        }
+    }
+
+    anim->next = next;
+    /* Worked out in 32 bits, 255 hundredths at a poll rate
+       above 257 Hz would overflow 16 bits */
+    ticks = (uint32_t) time * anim->poll_rate / 100;
+    if (ticks > UINT16_MAX)
+        ticks = UINT16_MAX;
+    else if (ticks == 0)
+        ticks = 1;
+    anim->ticks = ticks;
+}
+
+
+/*
+ * Draws the lit pixels of the current frame over whatever is already
+ * drawn, reading the next frame from program memory when the current
+ * one has been shown for long enough. The work is the same for every
+ * frame, at most ANIM_PIXELS pixels are read and drawn.
+ * @return true if a frame was drawn, false when no animation is playing
+ */
+bool anim_update (anim_t anim) {
+    uint8_t x;
+    uint8_t y;
+
+    if (anim->ticks == 0) {
+        if (!anim->next)
+            return false;
+        anim_frame_read (anim);
+        if (!anim->next)
+            return false;
+    }
+    anim->ticks--;
+
+    for (x = 0; x < ANIM_WIDTH; x++) {
+        for (y = 0; y < ANIM_HEIGHT; y++) {
+            if (anim->columns[x] & (1 << y))
+                tinygl_draw_point (tinygl_point (x, y), 1);
+        }
+    }
+    return true;
+}
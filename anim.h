@@ -0,0 +1,58 @@
+/** @file   anim.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the animation module of the catch throw game
+
+    An animation is a sequence of 5x7 frames kept in program memory.
+    Each frame starts with ANIM_FRAME giving how long it is shown,
+    followed by runs of unlit (ANIM_OFF) and lit (ANIM_ON) pixels that
+    cover all ANIM_PIXELS pixels, a column at a time from column 0.
+    The sequence finishes with ANIM_END.
+*/
+
+#ifndef ANIM_H
+#define ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#define ANIM_READ(ADDR) pgm_read_byte (ADDR)
+#else
+#define PROGMEM
+#define ANIM_READ(ADDR) (*(ADDR))
+#endif
+
+#define ANIM_WIDTH 5
+#define ANIM_HEIGHT 7
+#define ANIM_PIXELS (ANIM_WIDTH * ANIM_HEIGHT)
+
+/* Start of a frame shown for TIME hundredths of a second, up to 255 */
+#define ANIM_FRAME(TIME) (TIME)
+
+/* Runs of N pixels, N from 1 to ANIM_PIXELS */
+#define ANIM_OFF(N) (N)
+#define ANIM_ON(N) (0x80 | (N))
+
+#define ANIM_END 0
+
+typedef struct anim_struct
+{
+    const uint8_t *next; // Next frame in program memory, 0 when stopped
+    uint16_t ticks; // Updates left to show the current frame for
+    uint16_t poll_rate;
+    uint8_t columns[ANIM_WIDTH]; // Current frame, a bit for each row
+} anim_obj_t;
+
+typedef anim_obj_t *anim_t;
+
+anim_t anim_init (anim_obj_t *, uint16_t);
+
+void anim_play (anim_t, const uint8_t *);
+
+void anim_stop (anim_t);
+
+bool anim_update (anim_t);
+
+#endif //ANIM_H
@@ -7,36 +7,49 @@
 #ifndef BALL_H
 #define BALL_H
 
-#include "system.h"
-#include "tinygl.h"
+#include <stdint.h>
+#include <stdbool.h>
 
-uint8_t ball_x_cor;
-uint8_t ball_y_cor;
-bool ball_thrown;
-uint8_t ball_ticks;
+/* Size of the playing field, the same as the LED matrix */
+#define FIELD_ROWS_NUM 7
+#define FIELD_COLS_NUM 5
 
-void ball_init (void);
+/* Used for the direction the ball is going */
+#define UP 1
+#define DOWN (-1)
 
-void display_ball (void);
+typedef struct ball_struct
+{
+    uint8_t x_cor;
+    uint8_t y_cor;
+    bool thrown;
+    uint8_t ticks;
+    uint8_t speed;
+    int8_t direction;
+} ball_t;
 
-void change_ball_pos (uint8_t);
+void ball_init (ball_t *);
 
-void set_ball_thrown (uint8_t);
+void display_ball (ball_t *);
 
-void move_ball (void);
+void change_ball_pos (ball_t *, int8_t);
 
-void set_ball_speed (uint8_t);
+void set_ball_thrown (ball_t *, bool);
 
-uint8_t get_ball_y_pos(void);
+void move_ball (ball_t *);
 
-uint8_t get_ball_x_pos(void);
+void set_ball_speed (ball_t *, uint8_t);
 
-void receive_ball (uint8_t);
+uint8_t get_ball_y_pos(const ball_t *);
 
-int8_t get_ball_direction(void);
+uint8_t get_ball_x_pos(const ball_t *);
 
-void set_ball_direction(int8_t);
+void receive_ball (ball_t *, uint8_t);
 
-void ball_caught (uint8_t);
+int8_t get_ball_direction(const ball_t *);
+
+void set_ball_direction(ball_t *, int8_t);
+
+void ball_caught (ball_t *, uint8_t);
 
 #endif //BALL_H
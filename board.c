@@ -0,0 +1,243 @@
+/** @file   board.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A module to handle the game play of one board of the
+            throw and catch game
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "board.h"
+#include "ball.h"
+#include "player.h"
+
+#define MAX_ROW_POS (FIELD_ROWS_NUM - 1)
+#define MAX_COL_POS (FIELD_COLS_NUM - 1)
+
+#define SPEED_INDEX_MAX 2
+
+// Used for direction that the player is moving
+#define LEFT (-1)
+#define RIGHT 1
+
+
+/*
+ * Reports a game event to the board callback, if there is one
+ */
+static void board_event (board_t *board, board_event_t event)
+{
+    if (board->callback)
+        board->callback (board->callback_data, event);
+}
+
+
+/*
+ * Sends the given uint8_t to_send over IR to the other board
+ */
+static void board_send (board_t *board, uint8_t to_send)
+{
+    board->link->send (board->link->data, to_send);
+}
+
+
+/**
+ * Initialises a board ready for the first round
+ * @param board_link_t link the IR connection to the other board
+ * @param board_callback_t callback called with the game events, may be NULL
+ */
+void board_init (board_t *board, const board_link_t *link,
+                 board_callback_t callback, void *data)
+{
+    board->link = link;
+    board->callback = callback;
+    board->callback_data = data;
+    board->score = 0;
+    board->game_outcome = 2;
+    board->reset_tick = 0;
+    board->ball.x_cor = 0;
+    board->ball.y_cor = 0;
+    board->ball.speed = 0;
+    board->player.pos = 0;
+    board_reset (board);
+}
+
+
+/**
+ * Function to reset all the necessary game variables in order
+ * to replay the game
+ */
+void board_reset (board_t *board)
+{
+    board->state = STATE_INIT;
+    board->ball_on_screen = false;
+    board->speed_chosen = false;
+    board->speed_index = 0;
+    board->player.has_ball = false;
+    board->reset = false;
+    board->ball.ticks = 0; // So the first move of the next round is not delayed
+    set_ball_direction(&board->ball, UP);
+    set_ball_thrown(&board->ball, false);
+}
+
+
+/**
+ * Handles navswitch events in different stages of the game
+ * In setup it triggers the displayed speed option to change
+ * with the east/west navswitch press
+ * In gameplay it triggers the player to move with the
+ * north/south navswitch and causes the ball to be thrown when
+ * the navswitch it pushed
+ * @param uint8_t events the BOARD_INPUT bits of the navswitch pushes
+ */
+void board_input (board_t *board, uint8_t events)
+{
+    switch (board->state) {
+        case STATE_INIT:
+            if (events & BOARD_INPUT_PUSH)
+                board->state = STATE_SETUP;
+            break;
+        case STATE_SETUP:
+            if (events & BOARD_INPUT_WEST) {
+                if (board->speed_index < SPEED_INDEX_MAX)
+                    board->speed_index ++;
+            }
+            if (events & BOARD_INPUT_EAST) {
+                if (board->speed_index > 0)
+                    board->speed_index --;
+            }
+            if (events & BOARD_INPUT_PUSH) {
+                board->speed_chosen = true;
+                set_ball_speed(&board->ball, board->speed_index);
+                board->ball_on_screen = true;
+                board->player.has_ball = true;
+            }
+            break;
+        case STATE_PLAYING:
+            if (events & BOARD_INPUT_NORTH)
+                change_player_pos(&board->player, &board->ball, LEFT);
+            if (events & BOARD_INPUT_SOUTH)
+                change_player_pos(&board->player, &board->ball, RIGHT);
+            if ((events & BOARD_INPUT_PUSH) && board->player.has_ball) {
+                throw_ball(&board->player);
+                set_ball_thrown(&board->ball, true);
+                board_event(board, BOARD_EVENT_THROW);
+            }
+            break;
+        case STATE_OVER:
+            if (events & BOARD_INPUT_PUSH) {
+                board_send(board, true); // Sends 1 to the other board to start a new game
+                board->reset = true;
+            }
+            break;
+    }
+}
+
+
+/**
+ * Handles the game play of the board.
+ * This includes checking where the ball is and
+ * triggering other events based on this:
+ * Triggers the balls position to be sent when it reaches the
+ * top of the players screen
+ * Also checks whether the player has caught the ball when it
+ * reaches the bottom of the screen and causes the game
+ * to end if the player does not catch the ball
+ */
+void board_game_update (board_t *board)
+{
+    ball_t *ball = &board->ball;
+
+    if (board->state != STATE_PLAYING || !board->ball_on_screen)
+        return;
+
+    uint8_t x_pos = get_ball_x_pos (ball);
+    uint8_t y_pos = get_ball_y_pos (ball);
+    if (get_ball_direction(ball) == UP && y_pos == 0) { // Checks if the ball has reached the top
+        board_send(board, FIELD_ROWS_NUM - x_pos - 1); // Reverses the position for the other board
+        board->ball_on_screen = false;
+        set_ball_thrown(ball, false);
+    } else if (get_ball_direction(ball) == DOWN && y_pos == MAX_COL_POS) {
+        if (x_pos == get_player_pos(&board->player)) {
+            catch_ball(&board->player);
+            ball_caught(ball, get_player_pos(&board->player));
+            set_ball_direction(ball, UP);
+            board_event(board, BOARD_EVENT_CATCH);
+        } else {
+            board_send(board, WIN); // Indicating to the other player that they have won
+            board->game_outcome = LOSE;
+            board->state = STATE_OVER;
+            board_event(board, BOARD_EVENT_MISS);
+        }
+    }
+}
+
+
+/**
+ * Moves the ball along while it is in play, called at the
+ * rate the ball speed is counted in
+ */
+void board_ball_update (board_t *board)
+{
+    if (board->state == STATE_PLAYING)
+        display_ball(&board->ball);
+}
+
+
+/**
+ * Handles sending and receiving over IR to and from the other board
+ * Triggers events to happen based on what is received
+ */
+void board_link_update (board_t *board)
+{
+    const board_link_t *link = board->link;
+
+    switch(board->state) {
+        case STATE_INIT:
+            break;
+        case STATE_SETUP:
+            if (board->speed_chosen) {
+                board_send(board, board->speed_index); // sending the speed to the other board
+            }
+            if (link->ready_p (link->data)) {
+                uint8_t actual_speed = link->recv (link->data);
+                set_ball_speed(&board->ball, actual_speed);
+                board->speed_chosen = true;
+            }
+            if (board->speed_chosen) {
+                board->state = STATE_PLAYING; // changes to state_playing when speed is chosen
+                player_init(&board->player, &board->ball);
+            }
+            break;
+        case STATE_PLAYING:
+            if (link->ready_p (link->data)) {
+                uint8_t received = link->recv (link->data);
+                if (received == WIN) {
+                    board->game_outcome = WIN;
+                    board->score++;
+                    board->state = STATE_OVER; // changes to state over when win condition is met
+                    board_event(board, BOARD_EVENT_WIN);
+                } else if (received <= MAX_ROW_POS) { // game still being played
+                    receive_ball (&board->ball, received);
+                    set_ball_direction(&board->ball, DOWN);
+                    board->ball_on_screen = true;
+                    set_ball_thrown(&board->ball, true);
+                }
+            }
+            break;
+        case STATE_OVER:
+            if (link->ready_p (link->data)) {
+                uint8_t received = link->recv (link->data);
+                if (received == true) {
+                    board->reset = true;
+                }
+            }
+            if (board->reset && board->reset_tick == 1) {
+                board_reset(board); // reset all necessary variables and return to state_init, to replay game
+                board->reset_tick = 0;
+                board_event(board, BOARD_EVENT_RESET);
+            } else if (board->reset) {
+                board->reset_tick = 1 - board->reset_tick; // toggles between 0 and 1
+            }
+            break;
+    }
+}
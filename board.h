@@ -0,0 +1,80 @@
+/** @file   board.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the board module of the catch throw game
+
+    All of the game state of one board is kept in a board_t so that
+    more than one board can be run in the same program, for example
+    by the host match runner. The board does not use any hardware,
+    it is given the navswitch events, sends and receives over a
+    board_link_t and reports game events through a callback.
+*/
+
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ball.h"
+#include "player.h"
+
+// Bits of the navswitch events passed to board_input
+#define BOARD_INPUT_NORTH (1 << 0)
+#define BOARD_INPUT_EAST (1 << 1)
+#define BOARD_INPUT_SOUTH (1 << 2)
+#define BOARD_INPUT_WEST (1 << 3)
+#define BOARD_INPUT_PUSH (1 << 4)
+
+// The outcome of the game, also sent over IR
+#define LOSE 7
+#define WIN 8
+
+// States of the game play, to keep track of the game state
+typedef enum {STATE_INIT, STATE_SETUP, STATE_PLAYING,
+              STATE_OVER} state_t;
+
+// Game events reported to the board callback
+typedef enum {BOARD_EVENT_CATCH, BOARD_EVENT_THROW, BOARD_EVENT_MISS,
+              BOARD_EVENT_WIN, BOARD_EVENT_RESET} board_event_t;
+
+typedef void (*board_callback_t) (void *data, board_event_t event);
+
+// The IR connection to the other board
+typedef struct board_link_struct
+{
+    void (*send) (void *data, char ch);
+    bool (*ready_p) (void *data);
+    char (*recv) (void *data);
+    void *data;
+} board_link_t;
+
+typedef struct board_struct
+{
+    state_t state;
+    bool speed_chosen;
+    uint8_t speed_index;
+    bool ball_on_screen; // Indicates whether the ball is on the players screen
+    uint8_t game_outcome;
+    bool reset; // Used to trigger a reset to the game in order to restart a new round
+    uint8_t reset_tick; // Allows one cycle for all the tasks to reinitialise for a new round
+    uint8_t score; // To keep track of the players score over multiple games
+    ball_t ball;
+    player_t player;
+    const board_link_t *link;
+    board_callback_t callback;
+    void *callback_data;
+} board_t;
+
+void board_init (board_t *, const board_link_t *, board_callback_t, void *);
+
+void board_input (board_t *, uint8_t);
+
+void board_game_update (board_t *);
+
+void board_ball_update (board_t *);
+
+void board_link_update (board_t *);
+
+void board_reset (board_t *);
+
+#endif //BOARD_H
@@ -11,6 +11,7 @@
 #include <stdint.h>
 #include "system.h"
 #include "task.h"
+#include "board.h"
 #include "player.h"
 #include "ball.h"
 #include "navswitch.h"
@@ -18,9 +19,13 @@
 #include "tinygl.h"
 #include "../fonts/font3x5_1.h"
 #include "mmelody.h"
-#include "ticker.h"
-#include "tweeter.h"
+#include "mixer.h"
+#include "anim.h"
 #include "pio.h"
+#ifdef LOOPBACK
+#include "vlink.h"
+#include "ai.h"
+#endif
 
 // Defining tasks rates for the different tasks
 #define TWEETER_TASK_RATE 5000
@@ -30,55 +35,71 @@
 #define IR_TASK_RATE 100
 #define NAVSWITCH_TASK_RATE 100
 
-#define MIN_POS 0
 #define MAX_ROW_POS (LEDMAT_ROWS_NUM - 1)
 #define MAX_COL_POS (LEDMAT_COLS_NUM - 1)
 
 // Defining rates to initialise tinygl with
 #define PACER_RATE 500
+#define PLAYING_PACER_RATE 100
 #define MESSAGE_RATE 50
-
-// Used for direction that the player is moving
-#define LEFT (-1)
-#define RIGHT 1
-
-// Used for the direction that the ball is going
-#define UP 1
-#define DOWN (-1)
-
-// The outcome of the game
-#define LOSE 7
-#define WIN 8
+#define RESTART_MESSAGE_RATE 10
 
 // The speed to initialise mmelody with
 #define TUNE_BPM 200
 
-// States of the game play, to keep track of the game state
-typedef enum {STATE_INIT, STATE_SETUP, STATE_PLAYING,
-              STATE_OVER} state_t;
+#ifdef LOOPBACK
+/* The loopback build plays this board and a second board in the same
+   program, joined by a virtual IR link, with the computer player at
+   both. */
+#ifndef AI_SKILL
+#define AI_SKILL 95
+#endif
+#ifndef AI_REACTION
+#define AI_REACTION (AI_INPUT_RATE / 10)
+#endif
+#ifndef AI_SPEED
+#define AI_SPEED 2
+#endif
+#ifndef LOOPBACK_DELAY
+#define LOOPBACK_DELAY 2
+#endif
+#ifndef LOOPBACK_LOSS
+#define LOOPBACK_LOSS 0
+#endif
+
+#if NAVSWITCH_TASK_RATE != AI_INPUT_RATE || IR_TASK_RATE != AI_INPUT_RATE \
+    || DISPLAY_TASK_RATE != AI_BALL_RATE
+#error "The computer player needs the task rates it was written for"
+#endif
+#endif
 
-// Initialising the game state
-static state_t game_state = STATE_INIT;
+static const char speeds[] = {'1', '2', '3'}; // Chars of speeds the player can choose from
 
-char speeds[] = {'1', '2', '3'}; // Chars of speeds the player can choose from
-bool speed_chosen = false;
-uint8_t speed_index = 0;
-bool ball_on_screen = false; // Indicates whether the ball is on the players screen
+// The game state of this board
+static board_t board;
 
-uint8_t game_outcome = 2;
-bool reset = false; // Used to trigger a reset to the game in order to restart a new round
-uint8_t score = 0; // To keep track of the players score over multiple games
+#ifdef LOOPBACK
+// The other board and the computer players for the loopback build
+static board_t remote;
+static vlink_t vlink;
+static board_link_t local_link;
+static board_link_t remote_link;
+static ai_t local_ai;
+static ai_t remote_ai;
+#endif
 
 // Connect piezo tweeter to the first and third pin
 #define PIEZO1_PIO PIO_DEFINE (PORT_D, 4)
 #define PIEZO2_PIO PIO_DEFINE (PORT_D, 6)
 
 // Initializing variables used for the sound effects and music
-static tweeter_scale_t scale_table[] = TWEETER_SCALE_TABLE (TWEETER_TASK_RATE);
-static tweeter_t tweeter;
+static const mixer_scale_t scale_table[] = MIXER_SCALE_TABLE (TWEETER_TASK_RATE);
+static mixer_t mixer;
 static mmelody_t melody;
+static mmelody_t effects;
 static mmelody_obj_t melody_info;
-static tweeter_obj_t tweeter_info;
+static mmelody_obj_t effects_info;
+static mixer_obj_t mixer_info;
 
 /*
  * The song played on the winners board at the end of each round
@@ -90,23 +111,132 @@ static const char win_tune[] =
 "> "
 };
 
+// Animation played over the display
+static anim_obj_t anim_info;
+static anim_t anim;
+
+/*
+ * Animations for the game events, a line of ANIM_HEIGHT pixels
+ * for each column from the far end of the board to the player
+ */
+static const uint8_t anim_catch[] PROGMEM =
+{
+    ANIM_FRAME (6), ANIM_OFF (28), ANIM_ON (7),
+    ANIM_FRAME (6), ANIM_OFF (35),
+    ANIM_FRAME (6), ANIM_OFF (28), ANIM_ON (7),
+    ANIM_END
+};
+
+static const uint8_t anim_throw[] PROGMEM =
+{
+    ANIM_FRAME (4), ANIM_OFF (21), ANIM_ON (7), ANIM_OFF (7),
+    ANIM_FRAME (4), ANIM_OFF (14), ANIM_ON (7), ANIM_OFF (14),
+    ANIM_FRAME (4), ANIM_OFF (7), ANIM_ON (7), ANIM_OFF (21),
+    ANIM_FRAME (4), ANIM_ON (7), ANIM_OFF (28),
+    ANIM_END
+};
+
+#define ANIM_CROSS                                             \
+    ANIM_ON (1), ANIM_OFF (5), ANIM_ON (1),                    \
+    ANIM_OFF (1), ANIM_ON (2), ANIM_OFF (1), ANIM_ON (2), ANIM_OFF (1), \
+    ANIM_OFF (3), ANIM_ON (1), ANIM_OFF (3),                   \
+    ANIM_OFF (1), ANIM_ON (2), ANIM_OFF (1), ANIM_ON (2), ANIM_OFF (1), \
+    ANIM_ON (1), ANIM_OFF (5), ANIM_ON (1)
+
+static const uint8_t anim_miss[] PROGMEM =
+{
+    ANIM_FRAME (20), ANIM_CROSS,
+    ANIM_FRAME (10), ANIM_OFF (35),
+    ANIM_FRAME (20), ANIM_CROSS,
+    ANIM_FRAME (10), ANIM_OFF (35),
+    ANIM_FRAME (30), ANIM_CROSS,
+    ANIM_END
+};
+
+#define ANIM_BOX_1                                             \
+    ANIM_OFF (14), ANIM_OFF (3), ANIM_ON (1), ANIM_OFF (3), ANIM_OFF (14)
+
+#define ANIM_BOX_2                                             \
+    ANIM_OFF (7),                                              \
+    ANIM_OFF (2), ANIM_ON (3), ANIM_OFF (2),                   \
+    ANIM_OFF (2), ANIM_ON (1), ANIM_OFF (1), ANIM_ON (1), ANIM_OFF (2), \
+    ANIM_OFF (2), ANIM_ON (3), ANIM_OFF (2),                   \
+    ANIM_OFF (7)
+
+#define ANIM_BOX_3                                             \
+    ANIM_OFF (1), ANIM_ON (5), ANIM_OFF (1),                   \
+    ANIM_OFF (1), ANIM_ON (1), ANIM_OFF (3), ANIM_ON (1), ANIM_OFF (1), \
+    ANIM_OFF (1), ANIM_ON (1), ANIM_OFF (3), ANIM_ON (1), ANIM_OFF (1), \
+    ANIM_OFF (1), ANIM_ON (1), ANIM_OFF (3), ANIM_ON (1), ANIM_OFF (1), \
+    ANIM_OFF (1), ANIM_ON (5), ANIM_OFF (1)
+
+#define ANIM_BOX_4                                             \
+    ANIM_ON (7),                                               \
+    ANIM_ON (1), ANIM_OFF (5), ANIM_ON (1),                    \
+    ANIM_ON (1), ANIM_OFF (5), ANIM_ON (1),                    \
+    ANIM_ON (1), ANIM_OFF (5), ANIM_ON (1),                    \
+    ANIM_ON (7)
+
+static const uint8_t anim_win[] PROGMEM =
+{
+    ANIM_FRAME (8), ANIM_BOX_1,
+    ANIM_FRAME (8), ANIM_BOX_2,
+    ANIM_FRAME (8), ANIM_BOX_3,
+    ANIM_FRAME (8), ANIM_BOX_4,
+    ANIM_FRAME (8), ANIM_BOX_1,
+    ANIM_FRAME (8), ANIM_BOX_2,
+    ANIM_FRAME (8), ANIM_BOX_3,
+    ANIM_FRAME (8), ANIM_BOX_4,
+    ANIM_END
+};
+
+
+#ifndef LOOPBACK
+/*
+ * Sends the given char over IR to the other board
+ */
+static void ir_send (__unused__ void *data, char ch)
+{
+    ir_uart_putc (ch);
+}
+
+
+/*
+ * Checks if a char has been received over IR
+ */
+static bool ir_ready_p (__unused__ void *data)
+{
+    return ir_uart_read_ready_p ();
+}
+
 
 /*
- * Sends the given uint8_t to_send over IR to the other board
+ * Reads a received char from IR
  */
-void send_ir(uint8_t to_send)
+static char ir_recv (__unused__ void *data)
 {
-    ir_uart_putc(to_send);
+    return ir_uart_getc ();
 }
 
 
+// The IR connection of the board to the other board
+static const board_link_t ir_link =
+{
+    .send = ir_send,
+    .ready_p = ir_ready_p,
+    .recv = ir_recv,
+    .data = 0
+};
+#endif
+
+
 /*
  *  Initialisation for the tweeter task. Configures the pins for 
- *  output and initialises the tweeter
+ *  output and initialises the mixer
  */
 static void tweeter_task_init (void)
 {
-    tweeter = tweeter_init (&tweeter_info, TWEETER_TASK_RATE, scale_table);
+    mixer = mixer_init (&mixer_info, scale_table);
 
     pio_config_set (PIEZO1_PIO, PIO_OUTPUT_LOW);
 #ifdef PIEZO2_PIO
@@ -116,38 +246,155 @@ static void tweeter_task_init (void)
 
 
 /*
- * Initialises the tweeter for the music and sound effects
+ * Mixes the music and sound effects onto the tweeter, the music
+ * drives one terminal and the sound effects drive the other
  */
 static void tweeter_task (__unused__ void *data)
 {
-    bool state;
-    state = tweeter_update (tweeter);
+    uint8_t state;
+    state = mixer_update (mixer);
 
-    pio_output_set (PIEZO1_PIO, state);
+    pio_output_set (PIEZO1_PIO, (state & MIXER_OUTPUT_MUSIC) != 0);
 #ifdef PIEZO2_PIO
-    pio_output_set (PIEZO2_PIO, !state);
+    pio_output_set (PIEZO2_PIO, (state & MIXER_OUTPUT_EFFECTS) == 0);
 #endif
 }
 
 
 /*
- * Initialises mmelody for the tune task
+ * Plays a note of the music, the mmelody callback for the music
+ */
+static void music_note_play (void *data, uint8_t note, uint8_t velocity)
+{
+    mixer_note_play (data, MIXER_CHANNEL_MUSIC, 0, note, velocity);
+}
+
+
+/*
+ * Plays a note of a sound effect, the mmelody callback for the effects
+ */
+static void effects_note_play (void *data, uint8_t note, uint8_t velocity)
+{
+    mixer_note_play (data, MIXER_CHANNEL_EFFECTS, 0, note, velocity);
+}
+
+
+/*
+ * Initialises mmelody for the tune task, one for the music and
+ * one for the sound effects so that they can play at the same time
  */
 static void tune_task_init (void)
 {
     melody = mmelody_init (&melody_info, TUNE_TASK_RATE,
-			   (mmelody_callback_t) tweeter_note_play, tweeter);
+			   music_note_play, mixer);
+    effects = mmelody_init (&effects_info, TUNE_TASK_RATE,
+			    effects_note_play, mixer);
 
     mmelody_speed_set (melody, TUNE_BPM);
+    mmelody_speed_set (effects, TUNE_BPM);
 }
 
 
 /*
- * Updates mmelody, keeps the song playing
+ * Updates mmelody, keeps the song and sound effects playing
  */
 static void tune_task (__unused__ void *data)
 {
     mmelody_update (melody);
+    mmelody_update (effects);
+}
+
+
+/*
+ * Plays the sound effects, music and animations for the game events
+ * of the board. The animations are only started here and are played
+ * by the display task
+ */
+static void game_event (__unused__ void *data, board_event_t event)
+{
+    switch (event) {
+        case BOARD_EVENT_CATCH:
+            mmelody_play(effects, "C");  // Beeps when the player catches the ball
+            anim_play(anim, anim_catch);
+            break;
+        case BOARD_EVENT_THROW:
+            mmelody_play(effects, "E");  // Beeps when the player throws the ball
+            anim_play(anim, anim_throw);
+            break;
+        case BOARD_EVENT_MISS:
+            anim_play(anim, anim_miss);
+            break;
+        case BOARD_EVENT_WIN:
+            mmelody_play(melody, win_tune); // only winning board plays melody
+            anim_play(anim, anim_win);
+            break;
+        case BOARD_EVENT_RESET:
+            mmelody_play(melody, "");
+            mmelody_play(effects, "");
+            anim_stop(anim);
+#ifndef LOOPBACK
+            ir_uart_init (); // Clears anything left over from the last round
+#endif
+            break;
+    }
+}
+
+
+/*
+ * Sets up the display when the board changes to a new state
+ */
+static void display_state_set (const board_t *board)
+{
+    switch (board->state) {
+        case STATE_INIT:
+            tinygl_clear();
+            tinygl_text_mode_set(TINYGL_TEXT_MODE_SCROLL);
+            tinygl_text("CATCH! PRESS TO CHOOSE SPEED");
+            tinygl_text_speed_set(RESTART_MESSAGE_RATE);
+            break;
+        case STATE_SETUP:
+            tinygl_text_mode_set(TINYGL_TEXT_MODE_STEP);
+            tinygl_clear();
+            break;
+        case STATE_PLAYING:
+            tinygl_init(PLAYING_PACER_RATE);
+            break;
+        case STATE_OVER:
+            tinygl_clear();
+            break;
+    }
+}
+
+
+/*
+ * Shows the score once the animation for the end of the round
+ * has finished
+ * @return true when the score is being shown
+ */
+static bool display_score (const board_t *board)
+{
+    char buffer[] = {board->score + '0', '\0'}; // to display the score as a char
+
+    tinygl_clear();
+    if (anim_update(anim))
+        return false;
+    tinygl_text(buffer);
+    return true;
+}
+
+
+/*
+ * Draws the player and, when it is on this board, the ball
+ */
+static void display_field (const board_t *board)
+{
+    uint8_t x_pos = get_ball_x_pos (&board->ball);
+    uint8_t y_pos = get_ball_y_pos (&board->ball);
+
+    tinygl_clear();
+    tinygl_draw_point(tinygl_point (PLAYER_COL, get_player_pos (&board->player)), 1);
+    if (board->ball_on_screen && x_pos <= MAX_ROW_POS && y_pos <= MAX_COL_POS)
+        tinygl_draw_point(tinygl_point (y_pos, x_pos), 1);
 }
 
 
@@ -155,10 +402,12 @@ static void tune_task (__unused__ void *data)
  * Handles displaying messages, the player and the ball
  * at different stages of the game
  */
-static void display_task (__unused__ void *data)
+static void display_task (void *data)
 {
+    board_t *board = data;
     static bool init = false;
-    static bool game_init = false;
+    static state_t display_state = STATE_INIT;
+    static bool score_shown = false;
 
     if (!init) {
         tinygl_init(PACER_RATE);
@@ -170,100 +419,53 @@ static void display_task (__unused__ void *data)
         init = true;
     }
 
-    switch (game_state) {
-        static bool game_over_init = false;
+    if (board->state != display_state) {
+        display_state = board->state;
+        score_shown = false;
+        display_state_set(board);
+    }
 
+    switch (board->state) {
         case STATE_INIT:
-            tinygl_update();
             break;
         case STATE_SETUP: ; // Empty statement so that the label may be followed by a declaration
-            char speed[] = {speeds[speed_index], '\0'}; // to display the speed as a char
+            char speed[] = {speeds[board->speed_index], '\0'}; // to display the speed as a char
             tinygl_text(speed);
-            tinygl_update();
             break;
         case STATE_PLAYING:
-            if (!game_init) {
-                player_init();
-                game_init = true;
-            }
-            display_ball();
-            tinygl_update();
+            board_ball_update(board);
+            display_field(board);
+            anim_update(anim);
             break;
         case STATE_OVER:
-            if (!game_over_init) {
-                char buffer[] = {score + '0', '\0'}; // to display the score as a char
-                tinygl_text(buffer);
-                tinygl_update();
-                game_over_init = true;
-            }
-            tinygl_update();
-            if (reset) {
-                tinygl_clear();
-                tinygl_text_mode_set(TINYGL_TEXT_MODE_SCROLL);
-                tinygl_text("CATCH! PRESS TO CHOOSE SPEED");
-                tinygl_text_speed_set(10);
-                game_init = false;
-                game_over_init = false;
-            }
+            if (!score_shown)
+                score_shown = display_score(board);
             break;
     }
+    tinygl_update();
 }
 
 
 /**
- * Handles game tasks throughout the game.
- * This includes checking where the ball is and
- * triggering other events based on this:
- * Triggers the balls position to be sent when it reaches the
- * top of the players screen
- * Also checks whether the player has caught the ball when it
- * reaches the bottom of the screen and causes the game
- * to end if the player does not catch the ball
+ * Handles game tasks throughout the game, see board_game_update
  */
-static void game_task (__unused__ void *data)
+static void game_task (void *data)
 {
-    switch (game_state) {
-        case STATE_INIT:
-            break;
-        case STATE_SETUP:
-            break;
-        case STATE_PLAYING: ; // Empty statement so that the label may be followed by a declaration
-            uint8_t x_pos = get_ball_x_pos ();
-            uint8_t y_pos = get_ball_y_pos ();
-            if (ball_on_screen && get_ball_direction() == UP && y_pos == 0) { // Checks if the ball has reached the top
-                send_ir(TINYGL_HEIGHT - x_pos - 1); // Reverses the position for the other board
-                ball_on_screen = false;
-            } else if (ball_on_screen && get_ball_direction() == DOWN && y_pos == MAX_COL_POS) {
-                    if (x_pos == get_player_pos()) {
-                        catch_ball();
-                        mmelody_play(melody, "C");  // Beeps when the player catches the ball
-                        ball_caught(get_player_pos());
-                        set_ball_direction(UP);
-                    } else {
-                        send_ir(WIN); // Indicating to the other player that they have won
-                        game_outcome = LOSE;
-                        game_state = STATE_OVER;
-                        tinygl_clear();
-                    }
-            }
-            break;
-        case STATE_OVER:
-            break;
-    }
+    board_game_update (data);
 }
 
 
 /**
- * Handles navswitch events in different stages of the game
- * In setup it triggers the displayed speed option to change
- * with the north/south navswitch press
- * In gameplay it triggers the player to move with the
- * north/south navswitch and causes the ball to be thrown when
- * the navswitch it pushed
+ * Passes the navswitch events to the board, see board_input
+ * In the loopback build the computer player pushes the navswitch
  */
-static void navswitch_task (__unused__ void *data)
+static void navswitch_task (void *data)
 {
+#ifdef LOOPBACK
+    board_input (data, ai_input (&local_ai, data));
+#else
     static bool init = false;
+    uint8_t events = 0;
 
     if (!init) {
         navswitch_init();
@@ -272,154 +474,92 @@ static void navswitch_task (__unused__ void *data)
 
     navswitch_update ();
 
-    switch (game_state) {
-        case STATE_INIT:
-            if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-                game_state = STATE_SETUP;
-                tinygl_text_mode_set(TINYGL_TEXT_MODE_STEP);
-                tinygl_clear();
-            }
-            break;
-        case STATE_SETUP:
-            if (navswitch_push_event_p(NAVSWITCH_WEST)) {
-                if (speed_index < 2)
-                    speed_index ++;
-            }
-            if (navswitch_push_event_p(NAVSWITCH_EAST)) {
-                if (speed_index > 0)
-                    speed_index --;
-            }
-            if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-                speed_chosen = true;
-                set_ball_speed(speed_index);
-                ball_on_screen = true;
-                player_has_ball = true;
-                tinygl_clear();
-            }
-            break;
-        case STATE_PLAYING:
-            if (navswitch_push_event_p(NAVSWITCH_NORTH))
-                change_player_pos(LEFT);
-            if (navswitch_push_event_p(NAVSWITCH_SOUTH))
-                change_player_pos(RIGHT);
-            if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-                    throw_ball();
-                    set_ball_thrown(true);
-                    mmelody_play(melody, "E");  // Beeps when the player throws the ball
-            }
-            break;
-        case STATE_OVER:
-            if (navswitch_push_event_p(NAVSWITCH_PUSH)) {
-                send_ir(true); // Sends 1 to the other board to start a new game
-                reset = true;
-            }
-            break;
-    }
-}
-
-
-/**
- * Function to reset all the necessary game variables in order
- * to replay the game
- */
-void reset_game(void)
-{
-    game_state = STATE_INIT;
-    ball_on_screen = false;
-    speed_chosen = false;
-    speed_index = 0;
-    player_has_ball = false;
-    reset = false;
-    mmelody_play(melody, "");
-    set_ball_direction(UP);
-    set_ball_thrown(false);
+    if (navswitch_push_event_p(NAVSWITCH_NORTH))
+        events |= BOARD_INPUT_NORTH;
+    if (navswitch_push_event_p(NAVSWITCH_EAST))
+        events |= BOARD_INPUT_EAST;
+    if (navswitch_push_event_p(NAVSWITCH_SOUTH))
+        events |= BOARD_INPUT_SOUTH;
+    if (navswitch_push_event_p(NAVSWITCH_WEST))
+        events |= BOARD_INPUT_WEST;
+    if (navswitch_push_event_p(NAVSWITCH_PUSH))
+        events |= BOARD_INPUT_PUSH;
+
+    board_input (data, events);
+#endif
 }
 
 
 /**
- * Handles sending and receiving over IR to and from the other board
- * Triggers events to happen based on what is received
+ * Handles sending and receiving over IR to and from the other board,
+ * see board_link_update
+ * In the loopback build the other board is played here too, over
+ * the virtual link
  */
-static void send_recv_task (__unused__ void *data)
+static void send_recv_task (void *data)
 {
+#ifdef LOOPBACK
+    vlink_update (&vlink);
+    board_link_update (data);
+
+    board_input (&remote, ai_input (&remote_ai, &remote));
+    board_game_update (&remote);
+    board_link_update (&remote);
+#else
     static bool init = false;
-    // reset_tick allows one cycle for all the tasks to reinitialise for a new round
-    static uint8_t reset_tick = 0;
 
     if (!init) {
         ir_uart_init ();
         init = true;
-        reset_tick = 0;
     }
 
-    switch(game_state) {
-        case STATE_INIT:
-            break;
-        case STATE_SETUP:
-            if (speed_chosen) {
-                ir_uart_putc(speed_index); // sending the speed to the other board
-            }
-            if (ir_uart_read_ready_p()) {
-                char actual_speed = ir_uart_getc();
-                set_ball_speed(actual_speed);
-                speed_chosen = true;
-            }
-            if (speed_chosen) {
-                 game_state = STATE_PLAYING; // changes to state_playing when speed is chosen
-            }
-            break;
-        case STATE_PLAYING:
-             if (ir_uart_read_ready_p()) {
-                char received = ir_uart_getc();
-                if (received == WIN) {
-                    game_outcome = WIN;
-                    score++;
-                    game_state = STATE_OVER; // changes to state over when win condition is met
-                    tinygl_clear();
-                    mmelody_play(melody, win_tune); // only winning board plays melody
-                } else if (received >= MIN_POS && received <= MAX_ROW_POS) { // game still being played
-                    receive_ball (received);
-                    set_ball_direction(DOWN);
-                    ball_on_screen = true;
-                    set_ball_thrown(true);
-                }
-             }
-            break;
-        case STATE_OVER:
-            if (ir_uart_read_ready_p()) {
-                char received = ir_uart_getc();
-                if (received == true) {
-                    reset = true;
-                }
-            }
-            if (reset && reset_tick == 1)
-            {
-                reset_game(); // reset all necessary variables and return to state_init, to replay game
-                init = false;
-            }
-            if (reset) {
-                reset_tick = 1 - reset_tick; // toggles between 0 and 1
-            }
-            break;
-    }
+    board_link_update (data);
+#endif
 }
 
 
+#ifdef LOOPBACK
+/**
+ * Moves the ball of the other board in the loopback build, at the
+ * same rate as the display task moves the ball of this board
+ */
+static void remote_task (void *data)
+{
+    board_ball_update (data);
+}
+#endif
+
+
 int main (void)
 {
     task_t tasks[] =
     {
             {.func = tweeter_task, .period = TASK_RATE / TWEETER_TASK_RATE, .data = 0},
             {.func = tune_task, .period = TASK_RATE / TUNE_TASK_RATE, .data = 0},
-            {.func = display_task, .period = TASK_RATE / DISPLAY_TASK_RATE, .data = 0},
-            {.func = game_task, .period = TASK_RATE / GAME_TASK_RATE, .data = 0},
-            {.func = send_recv_task, .period = TASK_RATE / IR_TASK_RATE, .data = 0},
-            {.func = navswitch_task, .period = TASK_RATE / NAVSWITCH_TASK_RATE, .data = 0},
+            {.func = display_task, .period = TASK_RATE / DISPLAY_TASK_RATE, .data = &board},
+            {.func = game_task, .period = TASK_RATE / GAME_TASK_RATE, .data = &board},
+            {.func = send_recv_task, .period = TASK_RATE / IR_TASK_RATE, .data = &board},
+            {.func = navswitch_task, .period = TASK_RATE / NAVSWITCH_TASK_RATE, .data = &board},
+#ifdef LOOPBACK
+            {.func = remote_task, .period = TASK_RATE / DISPLAY_TASK_RATE, .data = &remote},
+#endif
     };
 
     system_init ();
     tweeter_task_init ();
     tune_task_init ();
+    anim = anim_init (&anim_info, DISPLAY_TASK_RATE);
+#ifdef LOOPBACK
+    vlink_init (&vlink, LOOPBACK_DELAY, LOOPBACK_LOSS, 1);
+    vlink_board_link (&vlink, 0, &local_link);
+    vlink_board_link (&vlink, 1, &remote_link);
+    ai_init (&local_ai, AI_SKILL, AI_REACTION, AI_SPEED, true, 1);
+    ai_init (&remote_ai, AI_SKILL, AI_REACTION, AI_SPEED, false, 2);
+    board_init (&board, &local_link, game_event, 0);
+    board_init (&remote, &remote_link, 0, 0);
+#else
+    board_init (&board, &ir_link, game_event, 0);
+#endif
 
     task_schedule (tasks, ARRAY_SIZE (tasks));
 
@@ -0,0 +1,107 @@
+/** @file   mixer.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A module to mix the music and sound effects of the
+            throw and catch game onto the piezo tweeter
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mixer.h"
+
+
+/*
+ * Initialises all of the voices to be silent
+ * @param mixer_obj_t obj the storage for the mixer
+ * @param mixer_scale_t scale_table made with MIXER_SCALE_TABLE for the
+ *        rate mixer_update is called at
+ */
+mixer_t mixer_init (mixer_obj_t *obj, const mixer_scale_t *scale_table) {
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0; i < MIXER_CHANNELS_NUM; i++) {
+        for (j = 0; j < MIXER_CHANNEL_VOICES; j++) {
+            obj->channels[i].voices[j].phase = 0;
+            obj->channels[i].voices[j].increment = 0;
+        }
+        obj->channels[i].error = 0;
+    }
+    obj->scale_table = scale_table;
+    return obj;
+}
+
+
+/*
+ * Starts a voice playing the given note, or silences it if the
+ * note or velocity is zero
+ * @param uint8_t channel MIXER_CHANNEL_MUSIC or MIXER_CHANNEL_EFFECTS
+ * @param uint8_t index the voice of the channel
+ * @param uint8_t note the note number, 12 notes to an octave
+ */
+void mixer_note_play (mixer_t mixer, uint8_t channel, uint8_t index,
+                      uint8_t note, uint8_t velocity) {
+    mixer_voice_obj_t *voice = &mixer->channels[channel].voices[index];
+    uint8_t octave = note / 12;
+    uint16_t increment;
+
+    if (note == 0 || velocity == 0) {
+        voice->increment = 0;
+        voice->phase = 0;
+        return;
+    }
+
+    increment = mixer->scale_table[note % 12];
+    for (; octave < MIXER_OCTAVE_BASE; octave++)
+        increment >>= 1;
+    /* Stops at the highest octave below half the update rate, higher
+       notes would fold back to a wrong pitch */
+    for (; octave > MIXER_OCTAVE_BASE && increment < MIXER_INCREMENT_LIMIT / 2; octave--)
+        increment <<= 1;
+    voice->increment = increment;
+}
+
+
+/*
+ * Advances every voice by one step, so the work done is the same no
+ * matter how many voices are playing. The square waves of the voices on
+ * each channel are summed and then reduced to a single bit by keeping
+ * the error left over from previous steps.
+ * @return the bits MIXER_OUTPUT_MUSIC and MIXER_OUTPUT_EFFECTS to drive
+ *         the terminals of the tweeter with
+ */
+uint8_t mixer_update (mixer_t mixer) {
+    uint8_t output = 0;
+    uint8_t silent = 0;
+    uint8_t i;
+    uint8_t j;
+
+    for (i = 0; i < MIXER_CHANNELS_NUM; i++) {
+        mixer_channel_obj_t *channel = &mixer->channels[i];
+        uint8_t level = 0;
+        bool active = false;
+
+        for (j = 0; j < MIXER_CHANNEL_VOICES; j++) {
+            channel->voices[j].phase += channel->voices[j].increment;
+            level += channel->voices[j].phase >> 15;
+            active |= channel->voices[j].increment != 0;
+        }
+
+        channel->error += level;
+        if (channel->error >= MIXER_CHANNEL_VOICES) {
+            channel->error -= MIXER_CHANNEL_VOICES;
+            output |= 1 << i;
+        }
+        if (!active)
+            silent |= 1 << i;
+    }
+
+    /* A silent channel copies the other one so a lone channel
+       drives the tweeter at full swing, like the tweeter did */
+    if (silent & MIXER_OUTPUT_EFFECTS) {
+        output = (output & MIXER_OUTPUT_MUSIC) ? MIXER_OUTPUT_MUSIC | MIXER_OUTPUT_EFFECTS : 0;
+    } else if (silent & MIXER_OUTPUT_MUSIC) {
+        output = (output & MIXER_OUTPUT_EFFECTS) ? MIXER_OUTPUT_MUSIC | MIXER_OUTPUT_EFFECTS : 0;
+    }
+    return output;
+}
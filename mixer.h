@@ -0,0 +1,91 @@
+/** @file   mixer.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the multi-voice sound mixer of the catch throw game
+
+    The mixer replaces the single square wave of the tweeter with
+    phase accumulator voices. The voices are grouped into two channels,
+    one for each terminal of the piezo, so that music on one channel
+    keeps playing while sound effects play on the other.
+*/
+
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Channel that plays the music */
+#define MIXER_CHANNEL_MUSIC 0
+
+/* Channel that plays the sound effects */
+#define MIXER_CHANNEL_EFFECTS 1
+
+#define MIXER_CHANNELS_NUM 2
+
+/* Number of voices summed on each channel */
+#ifndef MIXER_CHANNEL_VOICES
+#define MIXER_CHANNEL_VOICES 1
+#endif
+
+/* Bits of the value returned by mixer_update, one for each channel */
+#define MIXER_OUTPUT_MUSIC (1 << MIXER_CHANNEL_MUSIC)
+#define MIXER_OUTPUT_EFFECTS (1 << MIXER_CHANNEL_EFFECTS)
+
+/* Octave of the notes in the scale table, the octave of middle C */
+#define MIXER_OCTAVE_BASE 4
+
+typedef uint16_t mixer_scale_t;
+
+/* Phase increment per update of a note of frequency FREQ (Hz) */
+#define MIXER_INCREMENT(MIXER_RATE, FREQ) \
+    ((mixer_scale_t) ((FREQ) * 65536.0 / (MIXER_RATE) + 0.5))
+
+/* Increment of a note at half the update rate, the highest that can
+   be played */
+#define MIXER_INCREMENT_LIMIT 0x8000
+
+/* Phase increments of the twelve notes in the base octave */
+#define MIXER_SCALE_TABLE(MIXER_RATE)      \
+{                                          \
+    MIXER_INCREMENT (MIXER_RATE, 261.63),  \
+    MIXER_INCREMENT (MIXER_RATE, 277.18),  \
+    MIXER_INCREMENT (MIXER_RATE, 293.66),  \
+    MIXER_INCREMENT (MIXER_RATE, 311.13),  \
+    MIXER_INCREMENT (MIXER_RATE, 329.63),  \
+    MIXER_INCREMENT (MIXER_RATE, 349.23),  \
+    MIXER_INCREMENT (MIXER_RATE, 369.99),  \
+    MIXER_INCREMENT (MIXER_RATE, 392.00),  \
+    MIXER_INCREMENT (MIXER_RATE, 415.30),  \
+    MIXER_INCREMENT (MIXER_RATE, 440.00),  \
+    MIXER_INCREMENT (MIXER_RATE, 466.16),  \
+    MIXER_INCREMENT (MIXER_RATE, 493.88)   \
+}
+
+typedef struct mixer_voice_struct
+{
+    uint16_t phase;
+    uint16_t increment;
+} mixer_voice_obj_t;
+
+typedef struct mixer_channel_struct
+{
+    mixer_voice_obj_t voices[MIXER_CHANNEL_VOICES];
+    uint8_t error;
+} mixer_channel_obj_t;
+
+typedef struct mixer_struct
+{
+    mixer_channel_obj_t channels[MIXER_CHANNELS_NUM];
+    const mixer_scale_t *scale_table;
+} mixer_obj_t;
+
+typedef mixer_obj_t *mixer_t;
+
+mixer_t mixer_init (mixer_obj_t *, const mixer_scale_t *);
+
+void mixer_note_play (mixer_t, uint8_t, uint8_t, uint8_t, uint8_t);
+
+uint8_t mixer_update (mixer_t);
+
+#endif //MIXER_H
@@ -6,40 +6,22 @@
 */
 
 #include <stdbool.h>
-#include "system.h"
+#include <stdint.h>
 #include "player.h"
 #include "ball.h"
-#include "tinygl.h"
 
-/* Variable initialization */
-uint8_t player_pos; // Column number of the player
-bool player_has_ball = false; // Indicates whether the player is holding the ball
-
-#define PLAYER_START_ROW (LEDMAT_ROWS_NUM / 2) // Sets start row to the mid point of the LED matrix
-#define PLAYER_START_COL (LEDMAT_COLS_NUM - 1) // Sets start column to be the bottom column
-
-#define PACER_RATE 100
+#define PLAYER_START_ROW (FIELD_ROWS_NUM / 2) // Sets start row to the mid point of the LED matrix
 
 
 /*
  * Called for both players
- * Draws the player paddle at fixed location
- * Checks if player starts with ball and draws it
- */
-void player_init(void) {
-    tinygl_init(PACER_RATE);
-    player_pos = PLAYER_START_ROW;
-    tinygl_draw_point(tinygl_point (PLAYER_START_COL, player_pos), 1);
-    if (player_has_ball)
-        ball_init(); // Initialises the ball above the player
-}
-
-
-/*
- * Simple function used to update the tinygl with any changes
+ * Places the player paddle at fixed location
+ * Checks if player starts with ball and places it
  */
-void display_player(void) {
-    tinygl_update();
+void player_init(player_t *player, ball_t *ball) {
+    player->pos = PLAYER_START_ROW;
+    if (player->has_ball)
+        ball_init(ball); // Initialises the ball above the player
 }
 
 
@@ -47,16 +29,13 @@ void display_player(void) {
  * Changes player position left or right depending on navswitch push
  * Checks if player has the ball currently and moves it along with the
  * player movement.
- * @param int i defined int value either 1 (right) or -1 (left)
+ * @param int8_t position defined value either 1 (right) or -1 (left)
  */
-void change_player_pos(int position) {
-    if ((player_pos < 6 && position == 1) || (player_pos > 0 && position == -1)) {
-        tinygl_draw_point (tinygl_point (4, player_pos), 0);
-        player_pos += position;
-        tinygl_draw_point (tinygl_point (4, player_pos), 1);
-        if (player_has_ball)
-            change_ball_pos (position);
-        tinygl_update ();
+void change_player_pos(player_t *player, ball_t *ball, int8_t position) {
+    if ((player->pos < FIELD_ROWS_NUM - 1 && position == 1) || (player->pos > 0 && position == -1)) {
+        player->pos += position;
+        if (player->has_ball)
+            change_ball_pos (ball, position);
     }
 }
 
@@ -64,22 +43,22 @@ void change_player_pos(int position) {
 /*
  * Sets player to not have the ball
  */
-void throw_ball(void) {
-    player_has_ball = false;
+void throw_ball(player_t *player) {
+    player->has_ball = false;
 }
 
 
 /*
  * Sets the player to have the ball
  */
-void catch_ball(void) {
-    player_has_ball = true;
+void catch_ball(player_t *player) {
+    player->has_ball = true;
 }
 
 
 /*
  * To get current player position (row number)
  */
-uint8_t get_player_pos(void) {
-    return player_pos;
+uint8_t get_player_pos(const player_t *player) {
+    return player->pos;
 }
@@ -7,21 +7,27 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include "system.h"
-#include "tinygl.h"
+#include <stdint.h>
+#include <stdbool.h>
+#include "ball.h"
 
-bool player_has_ball;
+/* Column the player paddle is drawn on */
+#define PLAYER_COL (FIELD_COLS_NUM - 1)
 
-void player_init (void);
+typedef struct player_struct
+{
+    uint8_t pos; // Row number of the player
+    bool has_ball; // Indicates whether the player is holding the ball
+} player_t;
 
-void display_player (void);
+void player_init (player_t *, ball_t *);
 
-void change_player_pos (int);
+void change_player_pos (player_t *, ball_t *, int8_t);
 
-void throw_ball (void);
+void throw_ball (player_t *);
 
-void catch_ball (void);
+void catch_ball (player_t *);
 
-uint8_t get_player_pos(void);
+uint8_t get_player_pos(const player_t *);
 
 #endif
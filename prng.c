@@ -0,0 +1,40 @@
+/** @file   prng.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A small pseudo random number generator, so that
+            simulated IR loss and simulated players repeat
+            exactly for the same seed
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "prng.h"
+
+
+/*
+ * Seeds the generator, a seed of zero is replaced as the
+ * generator would otherwise only ever return zero
+ */
+void prng_init (prng_t *prng, uint16_t seed) {
+    prng->state = seed ? seed : 1;
+}
+
+
+/*
+ * To get the next number, a 16 bit xorshift
+ */
+uint16_t prng_next (prng_t *prng) {
+    prng->state ^= prng->state << 7;
+    prng->state ^= prng->state >> 9;
+    prng->state ^= prng->state << 8;
+    return prng->state;
+}
+
+
+/*
+ * Returns true the given percentage of the time
+ * @param uint8_t percent from 0 (never) to 100 (always)
+ */
+bool prng_chance (prng_t *prng, uint8_t percent) {
+    return prng_next (prng) % 100 < percent;
+}
@@ -0,0 +1,25 @@
+/** @file   prng.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the pseudo random number module of the
+            catch throw game
+*/
+
+#ifndef PRNG_H
+#define PRNG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef struct prng_struct
+{
+    uint16_t state;
+} prng_t;
+
+void prng_init (prng_t *, uint16_t);
+
+uint16_t prng_next (prng_t *);
+
+bool prng_chance (prng_t *, uint8_t);
+
+#endif //PRNG_H
@@ -0,0 +1,362 @@
+/** @file   sim.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Host match runner for the throw and catch game. Runs two
+            boards in one program joined by a virtual IR link, to play
+            many matches quickly for soak and regression testing
+
+    Usage: sim [-n matches] [-d delay_ms] [-l loss_percent] [-s seed]
+               [-t timeout_s] [-a skill_percent] [-r reaction_ms]
+               [-v speed] [-S soak_s]
+
+    With -a both boards are played by the computer player, otherwise
+    the players push the navswitch at random. With -S matches are
+    played for soak_s seconds of game time instead of -n matches, and
+    a rally still going at the end counts as a success.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "board.h"
+#include "vlink.h"
+#include "prng.h"
+#include "ai.h"
+
+// The rate the simulation is stepped at, and the rates of the board tasks
+#define SIM_TICK_RATE 500
+#define BALL_TASK_RATE 250
+#define GAME_TASK_RATE 100
+#define IR_TASK_RATE 100
+#define NAVSWITCH_TASK_RATE 100
+
+#define BOARDS_NUM 2
+
+// Defaults for the command line options
+#define MATCHES_DEFAULT 1000
+#define DELAY_MS_DEFAULT 0
+#define LOSS_DEFAULT 0
+#define SEED_DEFAULT 1
+#define TIMEOUT_S_DEFAULT 120
+#define REACTION_MS_DEFAULT 100
+#define SPEED_DEFAULT 2
+
+// Percentage chance of each navswitch push on a navswitch task tick
+#define PUSH_CHANCE 5
+#define MOVE_CHANCE 10
+#define THROW_CHANCE 2
+
+typedef struct sim_board_struct
+{
+    board_t board;
+    board_link_t link;
+    prng_t prng;
+    ai_t ai;
+    bool use_ai;
+    uint32_t catches;
+    uint32_t throws;
+    uint32_t misses;
+    uint32_t wins;
+    bool round_over;
+    bool match_over;
+} sim_board_t;
+
+// Catches since the start of the round, and the most in any round
+static uint32_t rally;
+static uint32_t longest_rally;
+
+
+/*
+ * Counts the game events of a board
+ */
+static void sim_event (void *data, board_event_t event)
+{
+    sim_board_t *sim = data;
+
+    switch (event) {
+        case BOARD_EVENT_CATCH:
+            sim->catches++;
+            if (++rally > longest_rally)
+                longest_rally = rally;
+            break;
+        case BOARD_EVENT_THROW:
+            sim->throws++;
+            break;
+        case BOARD_EVENT_MISS:
+            sim->misses++;
+            rally = 0;
+            sim->round_over = true;
+            break;
+        case BOARD_EVENT_WIN:
+            sim->wins++;
+            sim->round_over = true;
+            break;
+        case BOARD_EVENT_RESET:
+            if (sim->round_over)
+                sim->match_over = true;
+            break;
+    }
+}
+
+
+/*
+ * Makes up navswitch pushes for a simulated player, from the
+ * computer player or at random for the state the board is in
+ */
+static uint8_t sim_input (sim_board_t *sim)
+{
+    prng_t *prng = &sim->prng;
+    uint8_t events = 0;
+
+    if (sim->use_ai)
+        return ai_input (&sim->ai, &sim->board);
+
+    switch (sim->board.state) {
+        case STATE_INIT:
+        case STATE_OVER:
+            if (prng_chance (prng, PUSH_CHANCE))
+                events |= BOARD_INPUT_PUSH;
+            break;
+        case STATE_SETUP:
+            if (prng_chance (prng, MOVE_CHANCE))
+                events |= BOARD_INPUT_WEST;
+            if (prng_chance (prng, MOVE_CHANCE))
+                events |= BOARD_INPUT_EAST;
+            if (prng_chance (prng, PUSH_CHANCE))
+                events |= BOARD_INPUT_PUSH;
+            break;
+        case STATE_PLAYING:
+            if (prng_chance (prng, MOVE_CHANCE))
+                events |= BOARD_INPUT_NORTH;
+            if (prng_chance (prng, MOVE_CHANCE))
+                events |= BOARD_INPUT_SOUTH;
+            if (sim->board.player.has_ball && prng_chance (prng, THROW_CHANCE))
+                events |= BOARD_INPUT_PUSH;
+            break;
+    }
+    return events;
+}
+
+
+/*
+ * Starts a new match, both boards from the start screen and
+ * nothing in flight on the link
+ */
+static void sim_match_init (sim_board_t *sims, vlink_t *vlink,
+                            uint16_t delay, uint8_t loss, uint16_t seed)
+{
+    uint8_t i;
+
+    vlink_init (vlink, delay, loss, seed);
+    for (i = 0; i < BOARDS_NUM; i++) {
+        vlink_board_link (vlink, i, &sims[i].link);
+        board_init (&sims[i].board, &sims[i].link, sim_event, &sims[i]);
+        sims[i].round_over = false;
+        sims[i].match_over = false;
+    }
+    rally = 0;
+}
+
+
+/*
+ * Checks if a match that has run out of time is still in a rally,
+ * both boards playing with the ball held, on a board or on its
+ * way over the link, rather than stuck
+ */
+static bool sim_rallying_p (const sim_board_t *sims, const vlink_t *vlink)
+{
+    bool ball = false;
+    uint8_t i;
+
+    for (i = 0; i < BOARDS_NUM; i++) {
+        if (sims[i].board.state != STATE_PLAYING)
+            return false;
+        ball = ball || sims[i].board.ball_on_screen || sims[i].board.player.has_ball
+            || vlink->queues[i].count;
+    }
+    return ball;
+}
+
+
+/*
+ * Steps both boards by one simulation tick, running each
+ * board task when it is due
+ */
+static void sim_step (sim_board_t *sims, vlink_t *vlink, uint32_t tick)
+{
+    uint8_t i;
+
+    for (i = 0; i < BOARDS_NUM; i++) {
+        board_t *board = &sims[i].board;
+
+        if (tick % (SIM_TICK_RATE / NAVSWITCH_TASK_RATE) == 0)
+            board_input (board, sim_input (&sims[i]));
+        if (tick % (SIM_TICK_RATE / BALL_TASK_RATE) == 0)
+            board_ball_update (board);
+        if (tick % (SIM_TICK_RATE / GAME_TASK_RATE) == 0)
+            board_game_update (board);
+        if (tick % (SIM_TICK_RATE / IR_TASK_RATE) == 0)
+            board_link_update (board);
+    }
+    if (tick % (SIM_TICK_RATE / IR_TASK_RATE) == 0)
+        vlink_update (vlink);
+}
+
+
+int main (int argc, char **argv)
+{
+    sim_board_t sims[BOARDS_NUM];
+    vlink_t vlink;
+    uint32_t matches = MATCHES_DEFAULT;
+    uint32_t delay_ms = DELAY_MS_DEFAULT;
+    uint32_t loss = LOSS_DEFAULT;
+    uint32_t seed = SEED_DEFAULT;
+    uint32_t timeout_s = TIMEOUT_S_DEFAULT;
+    bool use_ai = false;
+    uint32_t skill = 0;
+    uint32_t reaction_ms = REACTION_MS_DEFAULT;
+    uint32_t speed = SPEED_DEFAULT;
+    uint32_t completed = 0;
+    uint32_t stalled = 0;
+    uint32_t rallying = 0;
+    uint32_t soak_s = 0;
+    uint64_t ticks = 0;
+    uint64_t sent = 0;
+    uint64_t lost = 0;
+    uint64_t overflowed = 0;
+    uint32_t rounds;
+    uint32_t catches;
+    uint32_t throws;
+    double simulated;
+    clock_t start;
+    double elapsed;
+    int opt;
+    uint8_t i;
+
+    while ((opt = getopt (argc, argv, "n:d:l:s:t:a:r:v:S:")) != -1) {
+        switch (opt) {
+            case 'n':
+                matches = strtoul (optarg, 0, 0);
+                break;
+            case 'd':
+                delay_ms = strtoul (optarg, 0, 0);
+                break;
+            case 'l':
+                loss = strtoul (optarg, 0, 0);
+                break;
+            case 's':
+                seed = strtoul (optarg, 0, 0);
+                break;
+            case 't':
+                timeout_s = strtoul (optarg, 0, 0);
+                break;
+            case 'a':
+                skill = strtoul (optarg, 0, 0);
+                use_ai = true;
+                break;
+            case 'r':
+                reaction_ms = strtoul (optarg, 0, 0);
+                break;
+            case 'v':
+                speed = strtoul (optarg, 0, 0);
+                break;
+            case 'S':
+                soak_s = strtoul (optarg, 0, 0);
+                break;
+            default:
+                fprintf (stderr, "Usage: %s [-n matches] [-d delay_ms] [-l loss_percent] "
+                         "[-s seed] [-t timeout_s] [-a skill_percent] [-r reaction_ms] "
+                         "[-v speed] [-S soak_s]\n", argv[0]);
+                return 1;
+        }
+    }
+    if (loss > 100) {
+        fprintf (stderr, "%s: loss must be a percentage\n", argv[0]);
+        return 1;
+    }
+    if (skill > 100) {
+        fprintf (stderr, "%s: skill must be a percentage\n", argv[0]);
+        return 1;
+    }
+    if (speed > 2 || reaction_ms * AI_INPUT_RATE / 1000 > UINT8_MAX) {
+        fprintf (stderr, "%s: speed must be 0 to 2 and reaction at most 2550 ms\n", argv[0]);
+        return 1;
+    }
+
+    for (i = 0; i < BOARDS_NUM; i++) {
+        prng_init (&sims[i].prng, seed * BOARDS_NUM + i);
+        sims[i].catches = sims[i].throws = sims[i].misses = sims[i].wins = 0;
+        sims[i].use_ai = false;
+    }
+
+    start = clock ();
+    while (soak_s ? ticks < (uint64_t) soak_s * SIM_TICK_RATE
+           : completed + stalled + rallying < matches) {
+        uint32_t tick;
+        uint32_t timeout = timeout_s * SIM_TICK_RATE;
+        uint32_t played = completed + stalled + rallying;
+
+        /* When soaking a match only ends early when a round is over */
+        if (soak_s)
+            timeout = (uint64_t) soak_s * SIM_TICK_RATE - ticks;
+
+        sim_match_init (sims, &vlink, delay_ms * IR_TASK_RATE / 1000, loss,
+                        seed + played);
+        for (i = 0; i < BOARDS_NUM && use_ai; i++) {
+            sims[i].use_ai = true;
+            ai_init (&sims[i].ai, skill, reaction_ms * AI_INPUT_RATE / 1000, speed,
+                     i == 0, (seed + played) * BOARDS_NUM + i);
+        }
+
+        /* A match is complete when both boards have seen the round end
+           and gone back to the start screen, so the win is not lost on
+           the link when the next match starts */
+        for (tick = 0; tick < timeout; tick++) {
+            sim_step (sims, &vlink, tick);
+            if (sims[0].match_over && sims[1].match_over)
+                break;
+        }
+        if (tick < timeout)
+            completed++;
+        else if (sim_rallying_p (sims, &vlink))
+            rallying++;
+        else
+            stalled++;
+        ticks += tick;
+        sent += vlink.sent;
+        lost += vlink.lost;
+        overflowed += vlink.overflowed;
+    }
+    elapsed = (double) (clock () - start) / CLOCKS_PER_SEC;
+
+    /* Every round ends with a miss on the losing board */
+    rounds = catches = throws = 0;
+    for (i = 0; i < BOARDS_NUM; i++) {
+        rounds += sims[i].misses;
+        catches += sims[i].catches;
+        throws += sims[i].throws;
+    }
+    simulated = (double) ticks / SIM_TICK_RATE;
+
+    printf ("matches:   %u completed, %u still rallying at the time limit, %u stalled\n",
+            completed, rallying, stalled);
+    printf ("rounds:    %u\n", rounds);
+    for (i = 0; i < BOARDS_NUM; i++) {
+        printf ("board %u:   %u wins, %u misses, %u catches, %u throws\n", i,
+                sims[i].wins, sims[i].misses, sims[i].catches, sims[i].throws);
+    }
+    printf ("ir:        %llu sent, %llu lost, %llu overflowed\n",
+            (unsigned long long) sent, (unsigned long long) lost,
+            (unsigned long long) overflowed);
+    printf ("rallies:   %.2f catches/s, %.2f throws/s, longest %u catches\n",
+            simulated > 0 ? catches / simulated : 0.0,
+            simulated > 0 ? throws / simulated : 0.0, longest_rally);
+    printf ("simulated: %.1f s\n", simulated);
+    printf ("elapsed:   %.3f s, %.0f matches/s\n", elapsed,
+            elapsed > 0 ? (completed + stalled + rallying) / elapsed : 0.0);
+
+    return stalled ? 2 : 0;
+}
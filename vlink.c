@@ -0,0 +1,118 @@
+/** @file   vlink.c
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  A module to join two boards of the throw and catch
+            game without IR, with a delay and loss on each byte
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "vlink.h"
+#include "board.h"
+#include "prng.h"
+
+
+/*
+ * Sends a byte towards the other end, to arrive after the link
+ * delay. The byte is lost at the link loss rate, or dropped if the other
+ * end has not read the bytes already on their way to it
+ */
+static void vlink_send (void *data, char ch)
+{
+    vlink_end_t *end = data;
+    vlink_t *vlink = end->vlink;
+    vlink_queue_t *queue = &vlink->queues[1 - end->index];
+    uint8_t tail;
+
+    vlink->sent++;
+    if (prng_chance (&vlink->prng, vlink->loss)) {
+        vlink->lost++;
+        return;
+    }
+    if (queue->count == VLINK_QUEUE_SIZE) {
+        vlink->overflowed++;
+        return;
+    }
+
+    tail = (queue->head + queue->count) % VLINK_QUEUE_SIZE;
+    queue->data[tail] = ch;
+    queue->due[tail] = vlink->tick + vlink->delay;
+    queue->count++;
+}
+
+
+/*
+ * Checks if the oldest byte on its way to this end has arrived
+ */
+static bool vlink_ready_p (void *data)
+{
+    vlink_end_t *end = data;
+    vlink_t *vlink = end->vlink;
+    vlink_queue_t *queue = &vlink->queues[end->index];
+
+    return queue->count && (int16_t) (vlink->tick - queue->due[queue->head]) >= 0;
+}
+
+
+/*
+ * Reads the oldest byte, only to be called when vlink_ready_p is true
+ */
+static char vlink_recv (void *data)
+{
+    vlink_end_t *end = data;
+    vlink_queue_t *queue = &end->vlink->queues[end->index];
+    char ch;
+
+    ch = queue->data[queue->head];
+    queue->head = (queue->head + 1) % VLINK_QUEUE_SIZE;
+    queue->count--;
+    return ch;
+}
+
+
+/**
+ * Initialises a link with nothing in flight
+ * @param uint16_t delay number of vlink_update calls a byte takes to arrive
+ * @param uint8_t loss percentage of bytes lost
+ * @param uint16_t seed to repeat the same losses
+ */
+void vlink_init (vlink_t *vlink, uint16_t delay, uint8_t loss, uint16_t seed)
+{
+    uint8_t i;
+
+    for (i = 0; i < VLINK_ENDS_NUM; i++) {
+        vlink->queues[i].head = 0;
+        vlink->queues[i].count = 0;
+        vlink->ends[i].vlink = vlink;
+        vlink->ends[i].index = i;
+    }
+    vlink->tick = 0;
+    vlink->delay = delay;
+    vlink->loss = loss;
+    vlink->sent = 0;
+    vlink->lost = 0;
+    vlink->overflowed = 0;
+    prng_init (&vlink->prng, seed);
+}
+
+
+/*
+ * Fills in the board link for one end of the virtual link
+ * @param uint8_t index the end, 0 or 1
+ */
+void vlink_board_link (vlink_t *vlink, uint8_t index, board_link_t *link)
+{
+    link->send = vlink_send;
+    link->ready_p = vlink_ready_p;
+    link->recv = vlink_recv;
+    link->data = &vlink->ends[index];
+}
+
+
+/*
+ * Moves time along for the bytes in flight
+ */
+void vlink_update (vlink_t *vlink)
+{
+    vlink->tick++;
+}
@@ -0,0 +1,60 @@
+/** @file   vlink.h
+    @author Chuan Law (81677469), Elizabeth Wilson (53469493)
+    @date   17 October 2017
+    @brief  Interface for the virtual IR link of the catch throw game
+
+    A virtual link joins two boards in the same program in place of
+    the IR transceivers. Each byte sent takes a set number of updates
+    to arrive and may be lost, to test the game over a poor IR
+    connection.
+*/
+
+#ifndef VLINK_H
+#define VLINK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "board.h"
+#include "prng.h"
+
+/* Bytes that can be in flight to each end at once */
+#define VLINK_QUEUE_SIZE 8
+
+#define VLINK_ENDS_NUM 2
+
+typedef struct vlink_queue_struct
+{
+    char data[VLINK_QUEUE_SIZE];
+    uint16_t due[VLINK_QUEUE_SIZE]; // Tick that each byte arrives on
+    uint8_t head;
+    uint8_t count;
+} vlink_queue_t;
+
+typedef struct vlink_struct vlink_t;
+
+typedef struct vlink_end_struct
+{
+    vlink_t *vlink;
+    uint8_t index;
+} vlink_end_t;
+
+struct vlink_struct
+{
+    vlink_queue_t queues[VLINK_ENDS_NUM]; // Bytes on their way to each end
+    vlink_end_t ends[VLINK_ENDS_NUM];
+    uint16_t tick;
+    uint16_t delay; // Updates before a sent byte arrives
+    uint8_t loss; // Percentage of sent bytes that are lost
+    prng_t prng;
+    uint32_t sent;
+    uint32_t lost; // Bytes lost at the loss rate
+    uint32_t overflowed; // Bytes dropped as the other end had not read its queue
+};
+
+void vlink_init (vlink_t *, uint16_t, uint8_t, uint16_t);
+
+void vlink_board_link (vlink_t *, uint8_t, board_link_t *);
+
+void vlink_update (vlink_t *);
+
+#endif //VLINK_H